@@ -58,6 +58,15 @@ int main(void)
   SET_BSTR_BYTE_LEN(bstrByte, 5);
   printf_s("%-6s %p: %2u, \"%s\"\n\n", "update", (void *)bstrByte, SysStringByteLen(bstrByte), (char *)bstrByte);
 
+  // *** use the BSTR_CONTAINER_PRINTF macro ***
+
+  // The string is formatted directly into the buffer of the container. The
+  // BSTR argument is passed along with its length, which bounds the scan for
+  // the terminating NUL.
+  BSTR_CONTAINER(fmtContainer, 32);
+  BSTR_CONTAINER_PRINTF(fmtContainer, L"%.*ls-%d", (int)GET_BSTR_LEN(bstrNum), bstrNum, 42);
+  printf_s("%-6s %p: %2u, L\"%S\"\n\n", "format", (void *)fmtContainer.bstr, SysStringLen(fmtContainer.bstr), fmtContainer.bstr);
+
   CoUninitialize();
   return 0;
 }
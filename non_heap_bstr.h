@@ -43,20 +43,29 @@
 ///   There cannot be just a single type declaration because the length of the
 ///   buffer array varies depending on the string to represent. In the
 ///   consequence, the macros specify new types, tailored to a specific buffer
-///   size each. <br>
+///   size each. Alternatively, a small set of shared types for rounded buffer
+///   sizes can be declared once and used for any number of containers. <br>
 ///   The actual implementation of the container also allows for binary content
 ///   and supports `SysAllocStringByteLen()`-like functionality. <br>
 ///   Furthermore, native memory alignment is taken into account, just like with
 ///   a heap-allocated `BSTR`. <br>
 ///   To extend the flexibility of this library, length-related operations are
-///   wrapped into macros, too.
+///   wrapped into macros, too. <br>
+///   Formatting and copying into containers is performed by a few small
+///   `static inline` helper functions behind the macros. These make the header
+///   include `<stdarg.h>`, `<stdio.h>` and `<string.h>` in addition to
+///   `<windows.h>`.
 // =============================================================================
 #ifndef HEADER_NON_HEAP_BSTR_63E45A1A_6124_4281_9104_C3B113C2A312_1_0
 #define HEADER_NON_HEAP_BSTR_63E45A1A_6124_4281_9104_C3B113C2A312_1_0
 #include <windows.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 // =============================================================================
 /// @defgroup detail    Implementation Detail
-///                     Memory alignment guard and generic template. Do not use.
+///                     Memory alignment guard, generic template and inline
+///                     helper functions. Do not use.
 /// @{
 // -----------------------------------------------------------------------------
 /// @brief Implementation detail - DO NOT USE.
@@ -89,16 +98,15 @@
 #endif
 // -----------------------------------------------------------------------------
 /// @brief Implementation detail - DO NOT USE.
-/// @details The INTERNAL_BSTR_CONTAINER__ macro creates a container on the
-///          stack frame or in static storage.
-/// @remark This macro is directly or subsequently used in the creation-related
-///         macros, as it contains the generic structure and components of the
-///         implementation.
+/// @details The INTERNAL_BSTR_CONTAINER_TYPE__ macro specifies the structure
+///          of a container. It is shared by the containers that introduce a
+///          new type for every instance, and by the type declarations of
+///          @ref tcreate.
 /// @note As the name indicates, this macro is only **internally** used.
-/// @param varname_   Name of the container to be instantiated.
+/// @param tag_       Tag name of the structure.
 /// @param bytecount_ Size of the buffer, in bytes.
-#define INTERNAL_BSTR_CONTAINER__(varname_, bytecount_)                                                                          \
-  struct tag_##varname_ {                                                                                                        \
+#define INTERNAL_BSTR_CONTAINER_TYPE__(tag_, bytecount_)                                                                         \
+  struct tag_ {                                                                                                                  \
     /* contains the `length` member */                                                                                           \
     INTERNAL_BSTR_CONTAINER_LENGTH_PREFIX__;                                                                                     \
     union {                                                                                                                      \
@@ -107,7 +115,146 @@
       /* byte-string buffer that shares its memory with `bstr`; used for the initialization with arbitrary data */               \
       char bytestr[((bytecount_) + sizeof(__int3264)) & ~(sizeof(__int3264) - 1)];                                               \
     };                                                                                                                           \
-  } varname_
+  }
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The INTERNAL_BSTR_CONTAINER__ macro creates a container on the
+///          stack frame or in static storage.
+/// @remark This macro is directly or subsequently used in the creation-related
+///         macros, as it contains the generic structure and components of the
+///         implementation.
+/// @note As the name indicates, this macro is only **internally** used.
+/// @param varname_   Name of the container to be instantiated.
+/// @param bytecount_ Size of the buffer, in bytes.
+#define INTERNAL_BSTR_CONTAINER__(varname_, bytecount_) \
+  INTERNAL_BSTR_CONTAINER_TYPE__(tag_##varname_, bytecount_) varname_
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The INTERNAL_BSTR_STATIC_ASSERT__ macro resolves to the keyword
+///          for a compile-time assertion in C and C++, respectively.
+/// @note As the name indicates, this macro is only **internally** used to
+///       verify that the length of a typed container fits into its buffer.
+#if defined(__cplusplus)
+#  define INTERNAL_BSTR_STATIC_ASSERT__ static_assert
+#else
+#  define INTERNAL_BSTR_STATIC_ASSERT__ _Static_assert
+#endif
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The internal_bstr_wprintf__ function formats into the buffer of a
+///          container and updates the length prefix.
+/// @note As the name indicates, this function is only **internally** used by
+///       the @ref BSTR_CONTAINER_PRINTF() macro.
+/// @param bstr     The `bstr` member of the container.
+/// @param bufcount Size of the buffer, in wide characters.
+/// @param format   Format string.
+/// @param ...      Arguments to be formatted.
+/// @return Length of the string, or -1 if the output was truncated or an
+///         error occurred.
+static inline int internal_bstr_wprintf__(WCHAR *bstr, size_t bufcount, _In_z_ _Printf_format_string_ const WCHAR *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  const int len = _vsnwprintf_s(bstr, bufcount, _TRUNCATE, format, args);
+  va_end(args);
+  ((UINT *)(void *)bstr)[-1] = (UINT)((len < 0 ? wcslen(bstr) : (size_t)len) * sizeof(WCHAR));
+  return len;
+}
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The internal_bstr_printf__ function formats into the buffer of a
+///          container for binary data and updates the length prefix.
+/// @note As the name indicates, this function is only **internally** used by
+///       the @ref BSTR_BYTE_CONTAINER_PRINTF() macro.
+/// @param bytestr  The `bytestr` member of the container.
+/// @param bufsize  Size of the buffer, in bytes.
+/// @param format   Format string.
+/// @param ...      Arguments to be formatted.
+/// @return Length of the data, or -1 if the output was truncated or an error
+///         occurred.
+static inline int internal_bstr_printf__(char *bytestr, size_t bufsize, _In_z_ _Printf_format_string_ const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  const int len = _vsnprintf_s(bytestr, bufsize, _TRUNCATE, format, args);
+  va_end(args);
+  ((UINT *)(void *)bytestr)[-1] = (UINT)(len < 0 ? strlen(bytestr) : (size_t)len);
+  return len;
+}
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The internal_bstr_copy__ function copies data into the buffer of a
+///          container, either at the beginning or at the end of the data that
+///          the length prefix specifies, appends the null-terminating
+///          character and updates the length prefix. The source may overlap
+///          with the buffer. A length prefix beyond the capacity is clamped to
+///          the capacity.
+/// @note As the name indicates, this function is only **internally** used by
+///       the copy-related macros.
+/// @param bytestr  The `bytestr` member of the container.
+/// @param bufsize  Size of the buffer, in bytes.
+/// @param append   Nonzero to append the data, zero to replace the content.
+/// @param src      Pointer to the data to be copied.
+/// @param size     Size of the data to be copied, in bytes.
+/// @param termsize Size of the null-terminating character, in bytes.
+/// @return Resulting length, in bytes, or -1 if the data was truncated or the
+///         length prefix was clamped.
+static inline int internal_bstr_copy__(char *bytestr, size_t bufsize, int append, const void *src, size_t size, size_t termsize)
+{
+  size_t offset = append ? ((UINT *)(void *)bytestr)[-1] : 0;
+  offset -= offset % termsize;
+  const size_t capacity = bufsize - termsize;
+  const int clamped = offset > capacity;
+  if (clamped)
+    offset = capacity;
+
+  const size_t avail = capacity - offset;
+  const size_t count = size < avail ? size : avail;
+  memmove(bytestr + offset, src, count);
+  memset(bytestr + offset + count, 0, termsize);
+  ((UINT *)(void *)bytestr)[-1] = (UINT)(offset + count);
+  return count == size && !clamped ? (int)(offset + count) : -1;
+}
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The internal_bstr_wcopy__ function is the wide-character
+///          counterpart of internal_bstr_copy__().
+/// @note As the name indicates, this function is only **internally** used by
+///       the copy-related macros.
+/// @param bstr     The `bstr` member of the container.
+/// @param bufcount Size of the buffer, in wide characters.
+/// @param append   Nonzero to append the string, zero to replace the content.
+/// @param src      Pointer to the characters to be copied.
+/// @param count    Number of wide characters to be copied.
+/// @return Resulting length, in wide characters, or -1 if the string was
+///         truncated.
+static inline int internal_bstr_wcopy__(WCHAR *bstr, size_t bufcount, int append, const WCHAR *src, size_t count)
+{
+  const int size = internal_bstr_copy__((char *)bstr, bufcount * sizeof(WCHAR), append, src, count * sizeof(WCHAR), sizeof(WCHAR));
+  return size < 0 ? -1 : size / (int)sizeof(WCHAR);
+}
+// -----------------------------------------------------------------------------
+/// @brief Implementation detail - DO NOT USE.
+/// @details The internal_bstr_widen__ function converts Latin-1 characters
+///          into wide characters in the buffer of a container, appends the
+///          null-terminating character and updates the length prefix.
+/// @note As the name indicates, this function is only **internally** used by
+///       the @ref BSTR_CONTAINER_WIDEN() macro.
+/// @param bstr     The `bstr` member of the container.
+/// @param bufcount Size of the buffer, in wide characters.
+/// @param src      Pointer to the characters to be converted.
+/// @param count    Number of characters to be converted.
+/// @return Resulting length, in wide characters, or -1 if the string was
+///         truncated.
+static inline int internal_bstr_widen__(WCHAR *bstr, size_t bufcount, const char *src, size_t count)
+{
+  const size_t len = count < bufcount - 1 ? count : bufcount - 1;
+  for (size_t i = 0; i < len; ++i)
+    bstr[i] = (WCHAR)(unsigned char)src[i];
+  bstr[len] = L'\0';
+  ((UINT *)(void *)bstr)[-1] = (UINT)(len * sizeof(WCHAR));
+  return len == count ? (int)len : -1;
+}
 // -----------------------------------------------------------------------------
 /// @}
 // =============================================================================
@@ -242,8 +389,144 @@
 // -----------------------------------------------------------------------------
 /// @}
 // =============================================================================
+/// @defgroup tcreate    BSTR Shared Container Types
+///                      Declare container types that are shared by any number
+///                      of containers.
+/// @details Every container created by the macros of @ref wcreate and
+///          @ref bcreate introduces a new structure type. In a translation
+///          unit that defines hundreds of `BSTR` constants, this bloats the
+///          debug information and slows down both compiling and linking. <br>
+///          The macros in this group separate the type declaration from the
+///          instantiation. Declare a small set of types for rounded sizes
+///          (e.g. 16, 64 and 256 characters) once, preferably in a common
+///          header file, and pick the smallest type that fits the string. The
+///          memory layout of such a container is identical to that of the
+///          other containers.
+/// @{
+// -----------------------------------------------------------------------------
+/// @brief Declare a `BSTR` container type.
+/// @details The BSTR_CONTAINER_TYPE macro declares a structure type via
+///          `typedef`. Objects of this type are `BSTR` containers that can be
+///          defined like any other variable. The `bstr` member is the `BSTR`.
+/// @param typename_ Name of the type to be declared.
+/// @param bufcount_ Size of the buffer, in wide characters, that must be large
+///                  enough for the longest string to represent, including the
+///                  null-terminating character.
+#define BSTR_CONTAINER_TYPE(typename_, bufcount_) \
+  typedef INTERNAL_BSTR_CONTAINER_TYPE__(tag_##typename_, (bufcount_) * sizeof(WCHAR)) typename_
+// -----------------------------------------------------------------------------
+/// @brief Declare a `BSTR` container type for binary data.
+/// @details The BSTR_BYTE_CONTAINER_TYPE macro declares a structure type via
+///          `typedef`. Objects of this type are `BSTR` containers that can be
+///          defined like any other variable. The `bstr` member is the `BSTR`.
+/// @param typename_ Name of the type to be declared.
+/// @param bufsize_  Size of the buffer, in bytes, that must be large enough for
+///                  the largest data to represent, including the
+///                  null-terminating character.
+#define BSTR_BYTE_CONTAINER_TYPE(typename_, bufsize_) \
+  typedef INTERNAL_BSTR_CONTAINER_TYPE__(tag_##typename_, bufsize_) typename_
+// -----------------------------------------------------------------------------
+/// @brief Create an initialized `BSTR` container of a shared type.
+/// @details Aim of the INITIALIZED_TYPED_BSTR_CONTAINER macro is both the
+///          creation and the initialization of a `BSTR` container on the stack
+///          frame or in static storage, using a type previously declared by
+///          @ref BSTR_CONTAINER_TYPE().
+/// @param varname_  Name of the container to be instantiated.
+/// @param typename_ Name of the container type.
+/// @param bufcount_ Size of the represented string, in wide characters,
+///                  including the null-terminating character. This must not
+///                  exceed the buffer size of the type, which is verified at
+///                  compile time.
+/// @param ...       Variadic expression to initialize the string buffer. <br>
+///                  For the description, see
+///                  @ref INITIALIZED_BSTR_CONTAINER().
+#define INITIALIZED_TYPED_BSTR_CONTAINER(varname_, typename_, bufcount_, /*initializer*/...)               \
+  typename_ varname_ = { .prefix = { .length = ((bufcount_) - 1) * sizeof(WCHAR) }, .bstr = __VA_ARGS__ }; \
+  INTERNAL_BSTR_STATIC_ASSERT__((bufcount_) <= ARRAYSIZE((varname_).bstr), "bufcount_ exceeds the container type")
+// -----------------------------------------------------------------------------
+/// @brief Create an initialized `BSTR` container of a shared type for binary
+///        data.
+/// @details Aim of the INITIALIZED_TYPED_BSTR_BYTE_CONTAINER macro is both the
+///          creation and the initialization of a `BSTR` container on the stack
+///          frame or in static storage, using a type previously declared by
+///          @ref BSTR_BYTE_CONTAINER_TYPE().
+/// @param varname_  Name of the container to be instantiated.
+/// @param typename_ Name of the container type.
+/// @param bufsize_  Size of the represented data, in bytes, including the
+///                  null-terminating character. This must not exceed the
+///                  buffer size of the type, which is verified at compile
+///                  time.
+/// @param ...       Variadic expression to initialize the string buffer. <br>
+///                  For the description, see
+///                  @ref INITIALIZED_BSTR_BYTE_CONTAINER().
+#define INITIALIZED_TYPED_BSTR_BYTE_CONTAINER(varname_, typename_, bufsize_, /*initializer*/...) \
+  typename_ varname_ = { .prefix = { .length = (bufsize_) - 1 }, .bytestr = __VA_ARGS__ };       \
+  INTERNAL_BSTR_STATIC_ASSERT__((bufsize_) <= ARRAYSIZE((varname_).bytestr), "bufsize_ exceeds the container type")
+// -----------------------------------------------------------------------------
+/// @brief Declare a `BSTR` variable, using a shared container type.
+/// @details The MAKE_TYPED_BSTR macro declares a `BSTR` variable in the current
+///          scope but restricts the visibility of the container implementation
+///          to the body block of a wrapping while-loop. The container object
+///          has static storage duration and is therefore zero-initialized.
+/// @param varname_  Name of the `BSTR` variable to be declared.
+/// @param typename_ Name of a type declared by @ref BSTR_CONTAINER_TYPE().
+#define MAKE_TYPED_BSTR(varname_, typename_)    \
+  BSTR varname_;                                \
+  do {                                          \
+    static typename_ bstr_container_##varname_; \
+    varname_ = bstr_container_##varname_.bstr;  \
+  } while (0)
+// -----------------------------------------------------------------------------
+/// @brief Declare a `BSTR` variable containing binary data, using a shared
+///        container type.
+/// @details The MAKE_TYPED_BSTR_BYTE macro declares a `BSTR` variable in the
+///          current scope but restricts the visibility of the container
+///          implementation to the body block of a wrapping while-loop. The
+///          container object has static storage duration and is therefore
+///          zero-initialized.
+/// @param varname_  Name of the `BSTR` variable to be declared.
+/// @param typename_ Name of a type declared by @ref BSTR_BYTE_CONTAINER_TYPE().
+#define MAKE_TYPED_BSTR_BYTE(varname_, typename_) \
+  MAKE_TYPED_BSTR(varname_, typename_)
+// -----------------------------------------------------------------------------
+/// @brief Declare and initialize a `BSTR` variable, using a shared container
+///        type.
+/// @details The MAKE_INITIALIZED_TYPED_BSTR macro declares a `BSTR` variable in
+///          the current scope but restricts the visibility of the container
+///          implementation to the body block of a wrapping while-loop. The
+///          container object has static storage duration and the variadic
+///          arguments are used to initialize it. <br>
+///          For the description of the parameters, see
+///          @ref INITIALIZED_TYPED_BSTR_CONTAINER().
+#define MAKE_INITIALIZED_TYPED_BSTR(varname_, typename_, bufcount_, /*initializer*/...)                    \
+  BSTR varname_;                                                                                           \
+  do {                                                                                                     \
+    static INITIALIZED_TYPED_BSTR_CONTAINER(bstr_container_##varname_, typename_, bufcount_, __VA_ARGS__); \
+    varname_ = bstr_container_##varname_.bstr;                                                             \
+  } while (0)
+// -----------------------------------------------------------------------------
+/// @brief Declare and initialize a `BSTR` variable containing binary data,
+///        using a shared container type.
+/// @details The MAKE_INITIALIZED_TYPED_BSTR_BYTE macro declares a `BSTR`
+///          variable in the current scope but restricts the visibility of the
+///          container implementation to the body block of a wrapping
+///          while-loop. The container object has static storage duration and
+///          the variadic arguments are used to initialize it. <br>
+///          For the description of the parameters, see
+///          @ref INITIALIZED_TYPED_BSTR_BYTE_CONTAINER().
+#define MAKE_INITIALIZED_TYPED_BSTR_BYTE(varname_, typename_, bufsize_, /*initializer*/...)                    \
+  BSTR varname_;                                                                                               \
+  do {                                                                                                         \
+    static INITIALIZED_TYPED_BSTR_BYTE_CONTAINER(bstr_container_##varname_, typename_, bufsize_, __VA_ARGS__); \
+    varname_ = bstr_container_##varname_.bstr;                                                                 \
+  } while (0)
+// -----------------------------------------------------------------------------
+/// @}
+// =============================================================================
 /// @defgroup wlength    BSTR Wide String Length
-///                      Get or set the length of a BSTR.
+///                      Get or set the length of a BSTR, or get the length
+///                      and capacity of a container or the length of a
+///                      literal.
 /// @{
 // -----------------------------------------------------------------------------
 /// @brief Retrieve the length of a `BSTR` containing wide characters.
@@ -270,10 +553,83 @@
 #define SET_BSTR_LEN(bstr_, length_) \
   ((UINT *)(void *)(bstr_))[-1] = (UINT)((length_) * sizeof(WCHAR))
 // -----------------------------------------------------------------------------
+/// @brief Retrieve the length of the string in a `BSTR` container.
+/// @details Other than @ref GET_BSTR_LEN(), this macro accesses the `length`
+///          member of the container object rather than dereferencing a
+///          pointer. The null-terminating character is not counted.
+/// @remark The optimizer may fold the load if the caller declares an
+///         initialized container `const`. However, the result is never an
+///         integer constant expression. For a compile-time constant, use
+///         @ref BSTR_LITERAL_LEN() on the initializer, or @ref get_bstr_len()
+///         on a `constexpr` container in C++.
+/// @param container_ Container object.
+#define GET_BSTR_CONTAINER_LEN(container_) \
+  ((UINT)((container_).prefix.length / sizeof(WCHAR)))
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the capacity of a `BSTR` container.
+/// @details The BSTR_CONTAINER_CAPACITY macro is a constant expression that
+///          specifies the maximum length of a string in the container, in
+///          wide characters. The null-terminating character is not counted.
+/// @remark Because of the native alignment of the buffer, the capacity may be
+///         greater than the size the container was created with.
+/// @param container_ Container object.
+#define BSTR_CONTAINER_CAPACITY(container_) \
+  ((UINT)(ARRAYSIZE((container_).bstr) - 1))
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a wide string literal.
+/// @details The BSTR_LITERAL_LEN macro is a constant expression that specifies
+///          the length of a wide string literal, in wide characters, as it is
+///          used to initialize a container. The null-terminating character is
+///          not counted.
+/// @param lit_ Wide string literal, such as L"abc".
+#define BSTR_LITERAL_LEN(lit_) \
+  ((UINT)(ARRAYSIZE(lit_) - 1))
+#if defined(__cplusplus)
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a `BSTR` containing wide characters (C++
+///        only).
+/// @details The get_bstr_len() overloads form a uniform accessor for a `BSTR`,
+///          a container and a wide string literal. This overload is equivalent
+///          to @ref GET_BSTR_LEN().
+/// @param bstr Non-NULL `BSTR`.
+/// @return Length of the string, in wide characters.
+inline UINT get_bstr_len(BSTR bstr) noexcept
+{
+  return GET_BSTR_LEN(bstr);
+}
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a wide string literal (C++ only).
+/// @details This overload is equivalent to @ref BSTR_LITERAL_LEN() and always
+///          a constant expression.
+/// @note The overload is selected for any `const` array of wide characters.
+///       For the `bstr` member of a `const` container, it would return the
+///       size of the buffer rather than the length of the string. Pass the
+///       container itself instead.
+/// @return Length of the literal, in wide characters.
+template<size_t N>
+constexpr UINT get_bstr_len(const WCHAR (&)[N]) noexcept
+{
+  return (UINT)(N - 1);
+}
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of the string in a `BSTR` container (C++ only).
+/// @details This overload is equivalent to @ref GET_BSTR_CONTAINER_LEN(). It is
+///          a constant expression if the container is declared `constexpr`.
+/// @param container Container object.
+/// @return Length of the string, in wide characters.
+template<class Container>
+constexpr auto get_bstr_len(const Container &container) noexcept -> decltype((UINT)(container.prefix.length / sizeof(WCHAR)))
+{
+  return GET_BSTR_CONTAINER_LEN(container);
+}
+#endif
+// -----------------------------------------------------------------------------
 /// @}
 // =============================================================================
 /// @defgroup blength    BSTR Byte String Length
-///                      Get or set the byte length of a BSTR.
+///                      Get or set the byte length of a BSTR, or get the byte
+///                      length and capacity of a container or the byte length
+///                      of a literal.
 /// @{
 // -----------------------------------------------------------------------------
 /// @brief Retrieve the length of a `BSTR` containing binary data.
@@ -300,6 +656,232 @@
 #define SET_BSTR_BYTE_LEN(bstr_, length_) \
   ((UINT *)(void *)(bstr_))[-1] = (UINT)(length_)
 // -----------------------------------------------------------------------------
+/// @brief Retrieve the length of the data in a `BSTR` container.
+/// @details Other than @ref GET_BSTR_BYTE_LEN(), this macro accesses the
+///          `length` member of the container object rather than dereferencing
+///          a pointer. The null-terminating character is not counted.
+/// @remark The optimizer may fold the load if the caller declares an
+///         initialized container `const`. However, the result is never an
+///         integer constant expression. For a compile-time constant, use
+///         @ref BSTR_LITERAL_BYTE_LEN() on the initializer, or
+///         @ref get_bstr_byte_len() on a `constexpr` container in C++.
+/// @param container_ Container object.
+#define GET_BSTR_CONTAINER_BYTE_LEN(container_) \
+  ((container_).prefix.length)
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the capacity of a `BSTR` container for binary data.
+/// @details The BSTR_BYTE_CONTAINER_CAPACITY macro is a constant expression
+///          that specifies the maximum length of the data in the container, in
+///          bytes. The null-terminating character is not counted.
+/// @remark Because of the native alignment of the buffer, the capacity may be
+///         greater than the size the container was created with.
+/// @param container_ Container object.
+#define BSTR_BYTE_CONTAINER_CAPACITY(container_) \
+  ((UINT)(ARRAYSIZE((container_).bytestr) - 1))
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a string literal, in bytes.
+/// @details The BSTR_LITERAL_BYTE_LEN macro is a constant expression that
+///          specifies the size of a string literal, in bytes, as it is used to
+///          initialize a container for binary data. The null-terminating
+///          character is not counted.
+/// @param lit_ String literal, such as "abc".
+#define BSTR_LITERAL_BYTE_LEN(lit_) \
+  ((UINT)(sizeof(lit_) - 1))
+#if defined(__cplusplus)
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a `BSTR` containing binary data (C++ only).
+/// @details The get_bstr_byte_len() overloads form a uniform accessor for a
+///          `BSTR`, a container and a string literal. This overload is
+///          equivalent to @ref GET_BSTR_BYTE_LEN().
+/// @param bstr Non-NULL `BSTR`.
+/// @return Length of the data, in bytes.
+inline UINT get_bstr_byte_len(BSTR bstr) noexcept
+{
+  return GET_BSTR_BYTE_LEN(bstr);
+}
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of a string literal, in bytes (C++ only).
+/// @details This overload is equivalent to @ref BSTR_LITERAL_BYTE_LEN() and
+///          always a constant expression.
+/// @note The overload is selected for any `const` array of characters. For the
+///       `bytestr` member of a `const` container, it would return the size of
+///       the buffer rather than the length of the data. Pass the container
+///       itself instead.
+/// @return Length of the literal, in bytes.
+template<size_t N>
+constexpr UINT get_bstr_byte_len(const char (&)[N]) noexcept
+{
+  return (UINT)(N - 1);
+}
+// -----------------------------------------------------------------------------
+/// @brief Retrieve the length of the data in a `BSTR` container (C++ only).
+/// @details This overload is equivalent to @ref GET_BSTR_CONTAINER_BYTE_LEN().
+///          It is a constant expression if the container is declared
+///          `constexpr`.
+/// @param container Container object.
+/// @return Length of the data, in bytes.
+template<class Container>
+constexpr auto get_bstr_byte_len(const Container &container) noexcept -> decltype((UINT)container.prefix.length)
+{
+  return GET_BSTR_CONTAINER_BYTE_LEN(container);
+}
+#endif
+// -----------------------------------------------------------------------------
+/// @}
+// =============================================================================
+/// @defgroup copy    BSTR Copy
+///                   Copy or append a string or a part of it to a BSTR
+///                   container.
+/// @details A part of a `BSTR`, such as a path segment, can be passed around
+///          as a pointer into the string along with its length, both derived
+///          from the `BSTR` and @ref GET_BSTR_LEN() without copying anything.
+///          The macros in this group are meant to turn such a part into a
+///          `BSTR` of its own only if it is really needed.
+/// @{
+// -----------------------------------------------------------------------------
+/// @brief Copy wide characters into a `BSTR` container.
+/// @details The BSTR_CONTAINER_ASSIGN macro replaces the content of a
+///          container with a copy of the specified characters, appends the
+///          null-terminating character and updates the length prefix. The
+///          source may point into the same container.
+/// @param container_ Container object.
+/// @param src_       Pointer to the first character to be copied.
+/// @param length_    Number of wide characters to be copied.
+/// @return Length of the string, in wide characters. If the string was
+///         truncated to fit into the buffer, the return value is -1 while the
+///         length prefix reflects the truncated string.
+#define BSTR_CONTAINER_ASSIGN(container_, src_, length_) \
+  internal_bstr_wcopy__((container_).bstr, ARRAYSIZE((container_).bstr), 0, src_, length_)
+// -----------------------------------------------------------------------------
+/// @brief Copy bytes into a `BSTR` container for binary data.
+/// @details The BSTR_BYTE_CONTAINER_ASSIGN macro replaces the content of a
+///          container with a copy of the specified bytes, appends the
+///          null-terminating character and updates the length prefix. The
+///          source may point into the same container.
+/// @param container_ Container object.
+/// @param src_       Pointer to the first byte to be copied.
+/// @param length_    Number of bytes to be copied.
+/// @return Length of the data, in bytes. If the data was truncated to fit into
+///         the buffer, the return value is -1 while the length prefix reflects
+///         the truncated data.
+#define BSTR_BYTE_CONTAINER_ASSIGN(container_, src_, length_) \
+  internal_bstr_copy__((container_).bytestr, ARRAYSIZE((container_).bytestr), 0, src_, length_, 1)
+// -----------------------------------------------------------------------------
+/// @brief Append wide characters to the string in a `BSTR` container.
+/// @details The BSTR_CONTAINER_APPEND macro copies the specified characters to
+///          the end of the string that the length prefix specifies, appends
+///          the null-terminating character and updates the length prefix. <br>
+///          Successive calls join several strings and separators in one pass,
+///          without scanning for null-terminating characters: <br>
+///          `SET_BSTR_LEN(c.bstr, 0);` <br>
+///          `BSTR_CONTAINER_APPEND(c, a, GET_BSTR_LEN(a));` <br>
+///          `BSTR_CONTAINER_APPEND(c, L";", 1);` <br>
+///          `BSTR_CONTAINER_APPEND(c, b, GET_BSTR_LEN(b));`
+/// @note The length prefix must equal the actual length of the string in the
+///       container. This is not necessarily the case for a container created
+///       by @ref INITIALIZED_BSTR_CONTAINER(), whose length prefix specifies
+///       the whole `bufcount_`, regardless of the initializer. Set the length
+///       using @ref SET_BSTR_LEN() or @ref BSTR_CONTAINER_ASSIGN() first. A
+///       length prefix beyond the capacity is clamped to the capacity, and -1
+///       is returned.
+/// @param container_ Container object.
+/// @param src_       Pointer to the first character to be copied.
+/// @param length_    Number of wide characters to be copied.
+/// @return Length of the resulting string, in wide characters. If the string
+///         was truncated to fit into the buffer, the return value is -1 while
+///         the length prefix reflects the truncated string.
+#define BSTR_CONTAINER_APPEND(container_, src_, length_) \
+  internal_bstr_wcopy__((container_).bstr, ARRAYSIZE((container_).bstr), 1, src_, length_)
+// -----------------------------------------------------------------------------
+/// @brief Append bytes to the data in a `BSTR` container for binary data.
+/// @details The BSTR_BYTE_CONTAINER_APPEND macro copies the specified bytes to
+///          the end of the data that the length prefix specifies, appends the
+///          null-terminating character and updates the length prefix.
+/// @note The length prefix must equal the actual length of the data in the
+///       container. This is not necessarily the case for a container created
+///       by @ref INITIALIZED_BSTR_BYTE_CONTAINER(), whose length prefix
+///       specifies the whole `bufsize_`, regardless of the initializer. Set
+///       the length using @ref SET_BSTR_BYTE_LEN() or
+///       @ref BSTR_BYTE_CONTAINER_ASSIGN() first. A length prefix beyond the
+///       capacity is clamped to the capacity, and -1 is returned.
+/// @param container_ Container object.
+/// @param src_       Pointer to the first byte to be copied.
+/// @param length_    Number of bytes to be copied.
+/// @return Length of the resulting data, in bytes. If the data was truncated
+///         to fit into the buffer, the return value is -1 while the length
+///         prefix reflects the truncated data.
+#define BSTR_BYTE_CONTAINER_APPEND(container_, src_, length_) \
+  internal_bstr_copy__((container_).bytestr, ARRAYSIZE((container_).bytestr), 1, src_, length_, 1)
+// -----------------------------------------------------------------------------
+/// @brief Widen Latin-1 characters into a `BSTR` container.
+/// @details The BSTR_CONTAINER_WIDEN macro replaces the content of a container
+///          with the specified ASCII or Latin-1 characters, converted into
+///          wide characters, appends the null-terminating character and
+///          updates the length prefix. <br>
+///          This allows to keep large sets of such strings in byte containers
+///          at half the memory size, and to create a wide `BSTR` only when it
+///          is passed to a function: <br>
+///          `BSTR_CONTAINER_WIDEN(c, (char *)b, GET_BSTR_BYTE_LEN(b))`
+/// @note The source must not overlap with the buffer of the container.
+/// @param container_ Container object.
+/// @param src_       Pointer to the first character to be converted.
+/// @param length_    Number of characters to be converted.
+/// @return Length of the string, in wide characters. If the string was
+///         truncated to fit into the buffer, the return value is -1 while the
+///         length prefix reflects the truncated string.
+#define BSTR_CONTAINER_WIDEN(container_, src_, length_) \
+  internal_bstr_widen__((container_).bstr, ARRAYSIZE((container_).bstr), src_, length_)
+// -----------------------------------------------------------------------------
+/// @}
+// =============================================================================
+/// @defgroup format    BSTR Formatting
+///                     Format data directly into a BSTR container.
+/// @{
+// -----------------------------------------------------------------------------
+/// @brief Format wide characters into a `BSTR` container.
+/// @details The BSTR_CONTAINER_PRINTF macro works like `_snwprintf_s()` but
+///          writes directly into the buffer of a container and updates the
+///          length prefix. The capacity is taken from the container. This
+///          saves the copy from a temporary buffer. <br>
+///          To bound the scan for the null-terminating character of a `BSTR`
+///          argument, pass its length as precision: <br>
+///          `BSTR_CONTAINER_PRINTF(c, L"%.*ls", (int)GET_BSTR_LEN(b), b)` <br>
+///          The output still ends at the first embedded null character though.
+/// @note The macro needs a container object as created by @ref wcreate or
+///       @ref tcreate. A `BSTR` declared by @ref MAKE_BSTR() does not carry its
+///       buffer size.
+/// @note Other than the remaining macros of this library, this macro calls
+///       into the C runtime. Its formatting functions may allocate memory
+///       internally, e.g. for floating-point values of a large precision or
+///       width.
+/// @param container_ Container object.
+/// @param ...        Format string, followed by the arguments to be formatted.
+/// @return Length of the string, in wide characters. The return value is -1 if
+///         the output was truncated to fit into the buffer, or if a formatting
+///         or encoding error occurred. The length prefix is then updated with
+///         the length of the null-terminated string found in the buffer.
+#define BSTR_CONTAINER_PRINTF(container_, /*format, args*/...) \
+  internal_bstr_wprintf__((container_).bstr, ARRAYSIZE((container_).bstr), __VA_ARGS__)
+// -----------------------------------------------------------------------------
+/// @brief Format bytes into a `BSTR` container for binary data.
+/// @details The BSTR_BYTE_CONTAINER_PRINTF macro works like `_snprintf_s()` but
+///          writes directly into the buffer of a container and updates the
+///          length prefix. The capacity is taken from the container.
+/// @note The macro needs a container object as created by @ref bcreate or
+///       @ref tcreate.
+/// @note Other than the remaining macros of this library, this macro calls
+///       into the C runtime. Its formatting functions may allocate memory
+///       internally, e.g. for floating-point values of a large precision or
+///       width.
+/// @param container_ Container object.
+/// @param ...        Format string, followed by the arguments to be formatted.
+/// @return Length of the data, in bytes. The return value is -1 if the output
+///         was truncated to fit into the buffer, or if a formatting or
+///         encoding error occurred. The length prefix is then updated with the
+///         length of the null-terminated data found in the buffer.
+#define BSTR_BYTE_CONTAINER_PRINTF(container_, /*format, args*/...) \
+  internal_bstr_printf__((container_).bytestr, ARRAYSIZE((container_).bytestr), __VA_ARGS__)
+// -----------------------------------------------------------------------------
 /// @}
 // =============================================================================
 #endif /* header guard */